@@ -0,0 +1,87 @@
+#include "Process.h"
+#include "Task.h"
+#include "ConsumableResource.h"
+#include <iostream>
+/**
+ * @file nested_process_check.cpp
+ * @brief Executable check for nested processes and resource leases.
+ *
+ * Each nested process consumes one unit of the consumable resources it is assigned, so the
+ * remaining capacity of a resource tells how many times it was used after its leases came back.
+ * Returns a non-zero exit code if any check fails.
+ */
+
+namespace {
+    int failures = 0;
+
+    /**
+     * @brief Record a failed check without stopping the run.
+     * @param condition Condition that must hold.
+     * @param message   Description of the check.
+     */
+    void check(const bool condition, const std::string &message) {
+        if (!condition) {
+            std::cerr << "FAILED: " << message << std::endl;
+            ++failures;
+        }
+    }
+
+    /**
+     * @brief Create a nested process with no tasks.
+     */
+    std::unique_ptr<Process> makeProcess(const std::string &name, const std::vector<std::string> &requiredResourceNames) {
+        return std::make_unique<Process>(name, name + " description", requiredResourceNames, 1);
+    }
+}
+
+int main() {
+    auto parent = std::make_unique<Process>("Parent", "Parent description", std::vector<std::string>{}, 1);
+    auto memory = std::make_unique<ConsumableResource>("Memory", 100);
+    auto cache = std::make_unique<ConsumableResource>("Cache", 100);
+    const auto *parentMemory = memory.get();
+    const auto *parentCache = cache.get();
+    parent->addResource(std::move(memory));
+    parent->addResource(std::move(cache));
+
+    // Only a resource the nested process requires itself can refuse its lease
+    auto optional = makeProcess("Optional", {});
+    auto own = std::make_unique<ConsumableResource>("Own", 10);
+    const auto *ownResource = own.get();
+    optional->addResource(std::move(own));
+    optional->addTask(std::make_unique<Task>("Uses Own", "Uses Own", std::vector<std::string>{"Own"}, 1));
+    optional->addTask(std::make_unique<Task>("Uses Missing", "Uses Missing", std::vector<std::string>{"Missing"}, 1));
+
+    // The grandchild covers Cache from its own pool, so the child must not lease the parent's Cache
+    auto covered = makeProcess("Covered", {});
+    auto grandchild = makeProcess("Grandchild", {"Cache"});
+    grandchild->addResource(std::make_unique<ConsumableResource>("Cache", 10));
+    covered->addTask(std::move(grandchild));
+    check(covered->getMissingResourceNames().empty(), "names covered by a descendant are not missing");
+
+    // Both siblings need the single Memory resource: the second one is deferred, not skipped
+    auto first = makeProcess("First", {"Memory"});
+    auto second = makeProcess("Second", {"Memory"});
+    auto cacheUser = makeProcess("Cache User", {"Cache"});
+    auto refused = makeProcess("Refused", {"Nowhere"});
+
+    parent->addTask(std::move(optional));
+    parent->addTask(std::move(covered));
+    parent->addTask(std::move(first));
+    parent->addTask(std::move(second));
+    parent->addTask(std::move(cacheUser));
+    parent->addTask(std::move(refused));
+    // Runs after the group, so it only finds Memory if every lease was returned
+    parent->addTask(std::make_unique<Task>("After Group", "Uses Memory", std::vector<std::string>{"Memory"}, 1));
+
+    parent->run();
+    check(ownResource->getRemainingCapacity() == 9, "a task with an optional missing resource does not skip its siblings");
+    check(parentMemory->getRemainingCapacity() == 97, "deferred sibling and follow-up task both use the returned Memory");
+    check(parentCache->getRemainingCapacity() == 99, "only Cache User consumes the parent's Cache");
+
+    // Leases must be back in the parent's pool for a second run to succeed
+    parent->run();
+    check(parentMemory->getRemainingCapacity() == 94, "leases are returned so the process can run again");
+
+    if (failures == 0) std::cout << "All nested process checks passed." << std::endl;
+    return failures == 0 ? 0 : 1;
+}
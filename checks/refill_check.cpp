@@ -0,0 +1,105 @@
+#include "ConsumableResource.h"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+/**
+ * @file refill_check.cpp
+ * @brief Executable check for the refill policies of ConsumableResource.
+ *
+ * The token bucket must never hand out more than capacity + rate * elapsed units, whether the
+ * bucket sat idle while full or many threads drain it at once.
+ * Returns a non-zero exit code if any check fails.
+ */
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    using Policy = ConsumableResource::RefillPolicy;
+
+    int failures = 0;
+
+    /**
+     * @brief Record a failed check without stopping the run.
+     * @param condition Condition that must hold.
+     * @param message   Description of the check.
+     */
+    void check(const bool condition, const std::string &message) {
+        if (!condition) {
+            std::cerr << "FAILED: " << message << std::endl;
+            ++failures;
+        }
+    }
+
+    /**
+     * @brief Allocate from several threads until the deadline.
+     * @return Number of successful allocations.
+     */
+    int drainConcurrently(ConsumableResource &resource, const int threadCount, const Clock::time_point deadline,
+                          const bool releaseAfterUse) {
+        std::atomic<int> allocated{0};
+        {
+            std::vector<std::jthread> threads;
+            for (int i = 0; i < threadCount; ++i) {
+                threads.emplace_back([&] {
+                    while (Clock::now() < deadline) {
+                        try {
+                            resource.allocate();
+                            ++allocated;
+                            if (releaseAfterUse) resource.release();
+                        } catch (const std::runtime_error &) {}
+                    }
+                });
+            }
+        }
+        return allocated;
+    }
+
+    /**
+     * @brief Largest number of units a token bucket may hand out since start.
+     */
+    double tokenBucketLimit(const int capacity, const int rate, const Clock::time_point start) {
+        return capacity + rate * std::chrono::duration<double>(Clock::now() - start).count();
+    }
+}
+
+int main() {
+    // Explicit replenish never goes beyond the total capacity
+    ConsumableResource budget("Budget", 10);
+    for (int i = 0; i < 10; ++i) budget.allocate();
+    check(!budget.isAvailableForUse(), "a resource without refill is depleted after its capacity is used");
+    check(budget.replenish(4) == 4 && budget.getRemainingCapacity() == 4, "replenish adds the requested units");
+    check(budget.replenish(100) == 6 && budget.getRemainingCapacity() == 10, "replenish stops at the total capacity");
+
+    // Every release returns the unit its allocate took
+    ConsumableResource memory("Memory", 1000, Policy::ReturnOnRelease);
+    drainConcurrently(memory, 16, Clock::now() + std::chrono::milliseconds(100), true);
+    check(memory.getRemainingCapacity() == 1000, "return on release restores the full capacity");
+
+    // A full bucket that sat idle must not bank units beyond its capacity
+    constexpr int capacity = 10;
+    constexpr int rate = 1000;
+    auto start = Clock::now();
+    ConsumableResource idle("Idle", capacity, Policy::TokenBucket, rate);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    const auto burstStart = Clock::now();
+    int burst = 0;
+    try {
+        for (;;) {
+            idle.allocate();
+            ++burst;
+        }
+    } catch (const std::runtime_error &) {}
+    check(burst >= capacity, "an idle bucket is full");
+    check(burst <= tokenBucketLimit(capacity, rate, burstStart), "an idle bucket bursts no more than its capacity");
+
+    // Concurrent acquirers never get more than capacity + rate * elapsed
+    start = Clock::now();
+    ConsumableResource bucket("Bucket", capacity, Policy::TokenBucket, rate);
+    const int allocated = drainConcurrently(bucket, 16, Clock::now() + std::chrono::milliseconds(200), false);
+    check(allocated >= capacity, "concurrent acquirers get at least the initial capacity");
+    check(allocated <= tokenBucketLimit(capacity, rate, start), "concurrent acquirers respect the refill rate");
+
+    if (failures == 0) std::cout << "All refill checks passed." << std::endl;
+    return failures == 0 ? 0 : 1;
+}
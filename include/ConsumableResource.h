@@ -2,25 +2,95 @@
 #define CONSUMABLE_RESOURCE_H
 
 #include "Resource.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
 
 /**
  * @brief Consumable resource that depletes with use, such as memory.
  *
  * This class represents a resource that has a finite capacity and can be consumed.
  * Once the resource is used, its remaining capacity decreases.
- * If the remaining capacity reaches zero, the resource is no longer available for use.
+ * If the remaining capacity reaches zero, the resource is no longer available for use
+ * until it is refilled according to its refill policy or replenished explicitly.
+ *
+ * The remaining capacity is split across several stripes so that concurrent acquirers
+ * mostly work on different counters instead of contending on a single one. Under the token bucket
+ * policy each stripe is its own bucket with a share of the refill rate.
  */
 class ConsumableResource final : public Resource {
+public:
+    /**
+     * @brief How consumed capacity comes back to the resource.
+     */
+    enum class RefillPolicy {
+        None,            ///< Capacity only comes back through replenish()
+        ReturnOnRelease, ///< Each release returns the unit taken by the matching allocate
+        TokenBucket      ///< Capacity refills over time at a configured rate
+    };
 private:
+    static constexpr std::size_t stripeCount = 8; ///< Number of independent capacity counters
+
+    /**
+     * @brief Capacity counter kept on its own cache line.
+     *
+     * The stripe holds refilledUnits() - emptyMark units, clamped to [0, limit]. Keeping a single
+     * mark lets a refill and a take, or a refill and an add, happen in one compare-and-swap.
+     */
+    struct alignas(64) CapacityStripe {
+        std::atomic<std::int64_t> emptyMark{0}; ///< Refill count at which the stripe is empty
+        int limit = 0;                          ///< Maximum units this stripe can hold
+        int refillUnitsPerSecond = 0;           ///< Share of the token bucket refill rate
+        std::int64_t refillPhase = 0;           ///< Offset of this stripe's refills, in rate-nanoseconds
+    };
+
     int totalCapacity;
-    int remainingCapacity;
+    RefillPolicy refillPolicy;
+    std::int64_t refillEpochNanoseconds; ///< Time the token bucket started refilling
+    std::array<CapacityStripe, stripeCount> stripes;
+
+    /**
+     * @brief Index of the stripe the calling thread tries first.
+     */
+    [[nodiscard]] static std::size_t homeStripe();
+    /**
+     * @brief Nanoseconds since the token bucket started refilling; zero for other policies.
+     */
+    [[nodiscard]] std::int64_t elapsedNanoseconds() const;
+    /**
+     * @brief Units a stripe has been refilled with since the epoch.
+     * @param stripe The stripe.
+     * @param elapsed Nanoseconds since the epoch.
+     */
+    [[nodiscard]] static std::int64_t refilledUnits(const CapacityStripe &stripe, std::int64_t elapsed);
+    /**
+     * @brief Units a stripe holds for a given mark.
+     * @param stripe The stripe.
+     * @param emptyMark Refill count at which the stripe is empty.
+     * @param refilled Units the stripe has been refilled with since the epoch.
+     */
+    [[nodiscard]] static int availableUnits(const CapacityStripe &stripe, std::int64_t emptyMark, std::int64_t refilled);
+    /**
+     * @brief Take one unit, starting from the caller's home stripe.
+     * @return true if a unit was taken, false if every stripe is empty.
+     */
+    bool tryTakeUnit();
+    /**
+     * @brief Add units, starting from the caller's home stripe, without exceeding the total capacity.
+     * @param units Number of units to add.
+     * @return Number of units actually added.
+     */
+    int addUnits(int units);
 public:
     /**
      * @brief Construct a new Consumable Resource object
      * @param name Name of the resource
      * @param capacity Capacity of the resource
+     * @param policy How consumed capacity comes back to the resource
+     * @param refillUnitsPerSecond Refill rate, required for the token bucket policy
      */
-    ConsumableResource(const std::string &name, int capacity);
+    ConsumableResource(const std::string &name, int capacity,
+        RefillPolicy policy = RefillPolicy::None, int refillUnitsPerSecond = 0);
 
     /**
      * @brief Check if the resource is available for use
@@ -28,19 +98,28 @@ public:
      */
     [[nodiscard]] bool isAvailableForUse() const override;
     /** @brief Allocate the resource
-     * This method does not change the remaining capacity.
+     * This method takes one unit of the remaining capacity.
      */
     void allocate() override;
     /** @brief Release the resource
-     * This method does not change the remaining capacity.
+     * This method returns one unit only under the return-on-release policy.
      */
     void release() override;
     /** @brief Display the resource details, including remaining capacity.
      */
     void use() const override;
+    /** @brief Add capacity back to the resource, up to its total capacity.
+     * @param units Number of units to add.
+     * @return Number of units actually added.
+     */
+    int replenish(int units);
     /** @brief Retrieve the remaining capacity of the resource.
      * @return Remaining capacity of the resource in units (e.g., MB).
      */
     [[nodiscard]] int getRemainingCapacity() const;
+    /** @brief Retrieve the refill policy of the resource.
+     * @return The refill policy.
+     */
+    [[nodiscard]] RefillPolicy getRefillPolicy() const;
 };
-#endif //CONSUMABLE_RESOURCE_H
\ No newline at end of file
+#endif //CONSUMABLE_RESOURCE_H
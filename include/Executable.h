@@ -2,6 +2,7 @@
 #define EXECUTABLE_H
 
 #include "Resource.h"
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -65,7 +66,7 @@ public:
      * @brief Executes the task represented by the executable.
      * This is a pure virtual function that must be implemented by derived classes.
      */
-    virtual void execute() const = 0;
+    virtual void execute() = 0;
     /**
      * @brief Checks if the executable can be executed with the available resources.
      * @param resourcePool A vector of unique pointers to available resources.
@@ -10,11 +10,57 @@
  * and a list of tasks (also Executable objects).
  * The process can execute its tasks while managing the resources it requires.
  *
+ * A process can also be added as a task of another process. In that case the parent leases the
+ * resources the nested process needs from its own pool, and consecutive nested processes run in
+ * parallel with each other. Leased resources are returned to the parent when the nested process finishes.
+ * Nested processes that run in parallel write to the console at the same time, so their output is unordered.
  */
 class Process final : public Executable {
 private:
+    /**
+     * @brief Outcome of leasing resources to a nested process.
+     */
+    enum class LeaseResult {
+        Granted,  ///< The nested process can run now
+        Deferred, ///< A resource it needs is leased to a sibling; retry once the sibling finishes
+        Refused   ///< A resource the nested process itself requires is not available
+    };
+
     std::vector<std::unique_ptr<Resource>> resourcePool; ///< Resources available to the process
     std::vector<std::unique_ptr<Executable>> tasks; ///< Tasks to be executed by the process
+    std::vector<const Resource*> leasedResources; ///< Resources in the pool that are leased from the parent
+
+    /**
+     * @brief Leases the resources a nested process is missing from this process's resource pool.
+     *
+     * Only one resource per missing name is leased (see getMissingResourceNames()).
+     * The leased resources are moved from this pool to the nested process's pool.
+     * Resources needed only by the nested process's subtree are leased when available; the tasks
+     * that need them are skipped individually otherwise.
+     *
+     * @param child Nested process that receives the lease.
+     * @param holders Siblings currently holding a lease from this process.
+     * @return The lease result. Nothing is leased unless the result is Granted.
+     */
+    LeaseResult leaseResourcesTo(Process &child, const std::vector<Process*> &holders);
+    /**
+     * @brief Takes back all resources previously leased to a nested process.
+     *
+     * Leases can be reclaimed in any order.
+     *
+     * @param child Nested process that returns its lease.
+     */
+    void reclaimResourcesFrom(Process &child);
+    /**
+     * @brief Runs a group of nested processes in parallel, each on its own leased resources.
+     *
+     * @param children Nested processes to run.
+     */
+    void executeNested(const std::vector<Process*> &children);
+    /**
+     * @brief Runs the tasks of the process in order, grouping consecutive nested processes.
+     */
+    void executeTasks();
 public:
     /**
      * @brief Constructor for the Process class.
@@ -39,17 +85,25 @@ public:
      * @param task Unique pointer to the task (Executable) to be added.
      */
     void addTask(std::unique_ptr<Executable> task);
+    /**
+     * @brief Collects the names of resources the process and its tasks need but cannot find in their own pools.
+     *
+     * Nested processes are checked recursively, so names a descendant covers from its own pool are left out.
+     * @return Unique resource names, in the order they are first required.
+     */
+    [[nodiscard]] std::vector<std::string> getMissingResourceNames() const;
     /**
      * @brief Executes the process by running its tasks and managing resources.
      *
      * This method overrides the execute method from the Executable class.
-     * @throw std::runtime_error if the process cannot be executed due to resource constraints or failed tasks.
+     * @throw std::runtime_error if the process cannot be executed due to resource constraints.
      */
-    void execute() const override;
+    void execute() override;
     /**
      * @brief Runs the process, managing its tasks and resources.
      *
-     * This method is responsible for the overall execution flow of the process.
+     * This method is responsible for the overall execution flow of the process,
+     * including leasing resources to nested processes.
      * @throw std::runtime_error if the process cannot be run due to resource constraints.
      */
     void run();
@@ -26,6 +26,6 @@ public:
      * @brief Executes the task using the assigned resources.
      * @throw std::runtime_error if the task cannot be executed due to insufficient resources.
      */
-    void execute() const override;
+    void execute() override;
 };
 #endif //TASK_H
\ No newline at end of file
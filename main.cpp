@@ -10,6 +10,27 @@ new Process("Compilation Process", "Compilation Process description",
     { "CentralProcessingUnit", "Memory"}, 15));
     compilationProcess->addResource(
         std::unique_ptr<UsableResource>(new UsableResource("CentralProcessingUnit", 4)));
-    compilationProcess->addResource(std::unique_ptr<ConsumableResource>(new ConsumableResource("Memory", 4096)));
+    compilationProcess->addResource(std::unique_ptr<ConsumableResource>(new ConsumableResource("Memory", 4096,
+        ConsumableResource::RefillPolicy::ReturnOnRelease)));
+    compilationProcess->addResource(
+        std::unique_ptr<UsableResource>(new UsableResource("GraphicsProcessingUnit", 2)));
+
+    // Nested processes lease what they need from the parent and run in parallel
+    auto frontendProcess = std::unique_ptr<Process>(
+new Process("Frontend Process", "Parses and checks sources", {}, 5));
+    frontendProcess->addResource(std::unique_ptr<ConsumableResource>(new ConsumableResource("Cache", 512)));
+    frontendProcess->addTask(std::unique_ptr<Task>(new Task("Parse", "Parse sources", { "Cache" }, 2)));
+    frontendProcess->addTask(std::unique_ptr<Task>(new Task("Check", "Check types", { "Cache" }, 3)));
+
+    auto shaderProcess = std::unique_ptr<Process>(
+new Process("Shader Process", "Compiles shaders", {}, 4));
+    shaderProcess->addTask(std::unique_ptr<Task>(
+        new Task("Compile Shaders", "Compile shaders", { "GraphicsProcessingUnit" }, 4)));
+
+    compilationProcess->addTask(std::move(frontendProcess));
+    compilationProcess->addTask(std::move(shaderProcess));
+    compilationProcess->addTask(std::unique_ptr<Task>(
+        new Task("Link", "Link objects", { "Memory" }, 2)));
+    compilationProcess->run();
 
 }
\ No newline at end of file
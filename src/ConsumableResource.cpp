@@ -1,28 +1,155 @@
 #include "ConsumableResource.h"
+#include <algorithm>
+#include <chrono>
+#include <functional>
 #include <stdexcept>
 #include <iostream>
+#include <thread>
 /**
  * @file ConsumableResource.cpp
  * @brief Implementation of the ConsumableResource class
  * This class represents a consumable resource with a finite capacity.
- * It provides methods to allocate, release, and use the resource.
+ * It provides methods to allocate, release, use and replenish the resource.
  * The resource can be checked for availability based on its remaining capacity.
- * If the resource is depleted, a warning is logged when attempting to release it.
+ * Depending on its refill policy, consumed capacity comes back on release, over time, or only when
+ * replenished explicitly. If a resource without refill is depleted, a warning is logged when attempting to release it.
  */
 
+namespace {
+    constexpr std::int64_t nanosecondsPerSecond = 1'000'000'000;
+
+    /**
+     * @brief Current time of the monotonic clock in nanoseconds.
+     */
+    std::int64_t nowInNanoseconds() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
 /**
  * @brief Construct a new Consumable Resource:: Consumable Resource object
  * @param name The name of the resource
  * @param capacity The total capacity of the resource
+ * @param policy How consumed capacity comes back to the resource
+ * @param refillUnitsPerSecond Refill rate for the token bucket policy
  *
- * @throw std::invalid_argument if capacity is less than or equal to zero
+ * @throw std::invalid_argument if capacity is less than or equal to zero, or if the token bucket
+ * policy is used with a refill rate outside (0, 1e9] units per second
  */
-ConsumableResource::ConsumableResource(const std::string &name, const int capacity)
-    : Resource(name, Type::Consumable), totalCapacity(capacity),
-      remainingCapacity(capacity) {
+ConsumableResource::ConsumableResource(const std::string &name, const int capacity,
+                                       const RefillPolicy policy, const int refillUnitsPerSecond)
+    : Resource(name, Type::Consumable), totalCapacity(capacity), refillPolicy(policy),
+      refillEpochNanoseconds(nowInNanoseconds()), stripes() {
     if (capacity <= 0) {
         throw std::invalid_argument("Capacity for resource '" + name + "' must be greater than zero.");
     }
+    if (policy == RefillPolicy::TokenBucket &&
+        (refillUnitsPerSecond <= 0 || refillUnitsPerSecond > nanosecondsPerSecond)) {
+        throw std::invalid_argument("Refill rate for resource '" + name + "' must be between 1 and 1e9 units per second.");
+    }
+    // The rate is only shared among stripes that can hold units, so none of it is lost
+    const int usedStripes = std::min(capacity, static_cast<int>(stripeCount));
+    const int rate = policy == RefillPolicy::TokenBucket ? refillUnitsPerSecond : 0;
+    for (int i = 0; i < usedStripes; ++i) {
+        auto &stripe = stripes[static_cast<std::size_t>(i)];
+        stripe.limit = capacity / usedStripes + (i < capacity % usedStripes ? 1 : 0);
+        stripe.refillUnitsPerSecond = rate / usedStripes + (i < rate % usedStripes ? 1 : 0);
+        // Stagger the stripes so their refills interleave and add up to the configured rate
+        stripe.refillPhase = nanosecondsPerSecond * i / usedStripes;
+        stripe.emptyMark.store(-stripe.limit, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Index of the stripe the calling thread tries first
+ * @return A stripe index derived from the calling thread's id
+ */
+std::size_t ConsumableResource::homeStripe() {
+    thread_local const std::size_t index = std::hash<std::thread::id>{}(std::this_thread::get_id()) % stripeCount;
+    return index;
+}
+
+/**
+ * @brief Nanoseconds since the token bucket started refilling
+ * @return Elapsed time, or zero when the resource does not refill over time
+ */
+std::int64_t ConsumableResource::elapsedNanoseconds() const {
+    if (refillPolicy != RefillPolicy::TokenBucket) return 0;
+    return nowInNanoseconds() - refillEpochNanoseconds;
+}
+
+/**
+ * @brief Units a stripe has been refilled with since the epoch
+ * @param stripe  The stripe
+ * @param elapsed Nanoseconds since the epoch
+ * @return floor((elapsed * rate + phase) / 1e9), split into whole seconds and a remainder so it cannot overflow
+ */
+std::int64_t ConsumableResource::refilledUnits(const CapacityStripe &stripe, const std::int64_t elapsed) {
+    return elapsed / nanosecondsPerSecond * stripe.refillUnitsPerSecond +
+           (elapsed % nanosecondsPerSecond * stripe.refillUnitsPerSecond + stripe.refillPhase) / nanosecondsPerSecond;
+}
+
+/**
+ * @brief Units a stripe holds for a given mark
+ * @param stripe    The stripe
+ * @param emptyMark Refill count at which the stripe is empty
+ * @param refilled  Units the stripe has been refilled with since the epoch
+ * @return Units available in the stripe; refills beyond its limit are dropped
+ */
+int ConsumableResource::availableUnits(const CapacityStripe &stripe, const std::int64_t emptyMark,
+                                       const std::int64_t refilled) {
+    return static_cast<int>(std::clamp<std::int64_t>(refilled - emptyMark, 0, stripe.limit));
+}
+
+/**
+ * @brief Take one unit, starting from the caller's home stripe and moving on to the others
+ * @return true if a unit was taken, false if every stripe is empty
+ *
+ * The refill of a stripe is applied by the same compare-and-swap that takes the unit.
+ */
+bool ConsumableResource::tryTakeUnit() {
+    const auto elapsed = elapsedNanoseconds();
+    const auto start = homeStripe();
+    for (std::size_t i = 0; i < stripeCount; ++i) {
+        auto &stripe = stripes[(start + i) % stripeCount];
+        const auto refilled = refilledUnits(stripe, elapsed);
+        std::int64_t mark = stripe.emptyMark.load(std::memory_order_relaxed);
+        for (int available = availableUnits(stripe, mark, refilled); available > 0;
+             available = availableUnits(stripe, mark, refilled)) {
+            if (stripe.emptyMark.compare_exchange_weak(mark, refilled - available + 1, std::memory_order_acquire,
+                                                       std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Add units to the stripes, never filling a stripe beyond its limit
+ * @param units Number of units to add
+ * @return Number of units actually added
+ */
+int ConsumableResource::addUnits(int units) {
+    const int requested = units;
+    const auto elapsed = elapsedNanoseconds();
+    const auto start = homeStripe();
+    for (std::size_t i = 0; i < stripeCount && units > 0; ++i) {
+        auto &stripe = stripes[(start + i) % stripeCount];
+        const auto refilled = refilledUnits(stripe, elapsed);
+        std::int64_t mark = stripe.emptyMark.load(std::memory_order_relaxed);
+        for (int available = availableUnits(stripe, mark, refilled); available < stripe.limit;
+             available = availableUnits(stripe, mark, refilled)) {
+            const int added = std::min(units, stripe.limit - available);
+            if (stripe.emptyMark.compare_exchange_weak(mark, refilled - available - added, std::memory_order_release,
+                                                       std::memory_order_relaxed)) {
+                units -= added;
+                break;
+            }
+        }
+    }
+    return requested - units;
 }
 
 /**
@@ -30,7 +157,7 @@ ConsumableResource::ConsumableResource(const std::string &name, const int capaci
  * @return true if the resource has remaining capacity, false otherwise
  */
 bool ConsumableResource::isAvailableForUse() const {
-    return remainingCapacity > 0;
+    return getRemainingCapacity() > 0;
 }
 
 /**
@@ -38,37 +165,66 @@ bool ConsumableResource::isAvailableForUse() const {
  * @throw std::runtime_error if the resource is out of capacity
  */
 void ConsumableResource::allocate() {
-    if (remainingCapacity <= 0) {
+    if (!tryTakeUnit()) {
         throw std::runtime_error("Resource '" + name + "' is out of capacity.");
     }
-    --remainingCapacity;
-    isAvailable = (remainingCapacity > 0);
 }
 
 /**
- * @brief Release the resource, making it available again if it has remaining capacity
- * If the resource is depleted, a warning is logged.
+ * @brief Release the resource, returning one unit under the return-on-release policy
+ * If a resource without refill is depleted, a warning is logged.
  */
 void ConsumableResource::release() {
-    if (remainingCapacity == 0 && !isAvailable) {
+    if (refillPolicy == RefillPolicy::ReturnOnRelease) {
+        addUnits(1);
+        return;
+    }
+    if (refillPolicy == RefillPolicy::None && getRemainingCapacity() == 0) {
         std::cerr << "Warning: Consumable resource '" + name + "' is depleted and cannot be reused until replenished."
                 << std::endl;
     }
-    isAvailable = (remainingCapacity > 0);
 }
 
 /**
  * @brief Use the resource, printing its current status
  */
 void ConsumableResource::use() const {
-    std::cout << "Using consumable resource '" + name + "' (remaining: " + std::to_string(remainingCapacity) << "/"
+    std::cout << "Using consumable resource '" + name + "' (remaining: " + std::to_string(getRemainingCapacity()) << "/"
             << totalCapacity << " MB)\n";
 }
 
+/**
+ * @brief Add capacity back to the resource, up to its total capacity
+ * @param units Number of units to add
+ * @return Number of units actually added
+ *
+ * @throw std::invalid_argument if units is negative
+ */
+int ConsumableResource::replenish(const int units) {
+    if (units < 0) {
+        throw std::invalid_argument("Cannot replenish resource '" + name + "' with a negative amount.");
+    }
+    return addUnits(units);
+}
+
 /**
  * @brief Get the remaining capacity of the resource
- * @return The remaining capacity
+ * @return The remaining capacity, including units the token bucket has refilled so far
  */
 int ConsumableResource::getRemainingCapacity() const {
-    return remainingCapacity;
+    const auto elapsed = elapsedNanoseconds();
+    int remaining = 0;
+    for (const auto &stripe: stripes) {
+        remaining += availableUnits(stripe, stripe.emptyMark.load(std::memory_order_relaxed),
+                                    refilledUnits(stripe, elapsed));
+    }
+    return remaining;
+}
+
+/**
+ * @brief Get the refill policy of the resource
+ * @return The refill policy
+ */
+ConsumableResource::RefillPolicy ConsumableResource::getRefillPolicy() const {
+    return refillPolicy;
 }
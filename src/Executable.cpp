@@ -24,6 +24,11 @@ durationInUnits(durationInUnits), assignedResources(){
     if (durationInUnits <= 0) throw std::invalid_argument("Duration for '" + name + "' must be positive");
 }
 
+/**
+ * @brief Virtual destructor for the Executable class.
+ */
+Executable::~Executable() = default;
+
 /**
  * @brief Retrieves the name of the executable.
  */
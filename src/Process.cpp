@@ -1,5 +1,9 @@
 #include "Process.h"
+#include <algorithm>
+#include <condition_variable>
 #include <iostream>
+#include <mutex>
+#include <thread>
 /**
  * @file Process.cpp
  * @brief Implementation of the Process class
@@ -33,20 +37,183 @@ void Process::addTask(std::unique_ptr<Executable> task) {
 }
 
 /**
- * @brief Execute the process and its tasks
+ * @brief Collect the resource names the process and its tasks need but cannot find in their own pools
+ * @return Unique resource names, in the order they are first required
  */
-void Process::execute() const {
-    if (!requiredResourceNames.empty() && assignedResources.size() != requiredResourceNames.size()) {
-        throw std::runtime_error("Required resource names mismatch for process: " + name);
+std::vector<std::string> Process::getMissingResourceNames() const {
+    std::vector<std::string> names;
+    auto appendMissing = [this, &names](const std::vector<std::string> &source) {
+        for (const auto &resourceName: source) {
+            const bool inPool = std::any_of(resourcePool.begin(), resourcePool.end(),
+                [&resourceName](const std::unique_ptr<Resource> &resource) {
+                    return resource->getName() == resourceName && resource->isAvailableForUse();
+                });
+            if (!inPool && std::find(names.begin(), names.end(), resourceName) == names.end()) {
+                names.push_back(resourceName);
+            }
+        }
+    };
+    appendMissing(requiredResourceNames);
+    for (const auto &task: tasks) {
+        if (const auto *nested = dynamic_cast<const Process *>(task.get())) {
+            appendMissing(nested->getMissingResourceNames());
+        } else {
+            appendMissing(task->getRequiredResourceNames());
+        }
     }
-    std::cout << "Executing Process: " << name << " - " << description << std::endl;
-    if (!assignedResources.empty()) {
-        for (const auto* resource : assignedResources) {
-            resource->use();
+    return names;
+}
+
+/**
+ * @brief Lease the resources a nested process is missing from this process's pool
+ * @param child   Nested process that receives the lease
+ * @param holders Siblings currently holding a lease from this process
+ * @return Granted if the nested process can run now, Deferred if it has to wait for a sibling,
+ *         Refused if a resource it requires itself is not available
+ */
+Process::LeaseResult Process::leaseResourcesTo(Process &child, const std::vector<Process *> &holders) {
+    const auto resourceNames = child.getMissingResourceNames();
+    // Reserve up front so moving resources below cannot throw halfway through a lease
+    child.resourcePool.reserve(child.resourcePool.size() + resourceNames.size());
+    child.leasedResources.reserve(child.leasedResources.size() + resourceNames.size());
+
+    for (const auto &resourceName: resourceNames) {
+        const auto it = std::find_if(resourcePool.begin(), resourcePool.end(),
+            [&resourceName](const std::unique_ptr<Resource> &resource) {
+                return resource->getName() == resourceName && resource->isAvailableForUse();
+            });
+        if (it != resourcePool.end()) {
+            child.leasedResources.push_back(it->get());
+            child.resourcePool.push_back(std::move(*it));
+            resourcePool.erase(it);
+            continue;
+        }
+
+        const bool heldBySibling = std::any_of(holders.begin(), holders.end(), [&resourceName](const Process *holder) {
+            return std::any_of(holder->leasedResources.begin(), holder->leasedResources.end(),
+                [&resourceName](const Resource *resource) { return resource->getName() == resourceName; });
+        });
+        const bool requiredByChild = std::find(child.requiredResourceNames.begin(), child.requiredResourceNames.end(),
+                                               resourceName) != child.requiredResourceNames.end();
+        if (heldBySibling || requiredByChild) {
+            reclaimResourcesFrom(child);
+            return heldBySibling ? LeaseResult::Deferred : LeaseResult::Refused;
+        }
+    }
+    return LeaseResult::Granted;
+}
+
+/**
+ * @brief Return every resource leased to a nested process back to this process's pool
+ * @param child Nested process that returns its lease
+ */
+void Process::reclaimResourcesFrom(Process &child) {
+    for (const auto *leased: child.leasedResources) {
+        const auto it = std::find_if(child.resourcePool.begin(), child.resourcePool.end(),
+            [leased](const std::unique_ptr<Resource> &resource) { return resource.get() == leased; });
+        resourcePool.push_back(std::move(*it));
+        child.resourcePool.erase(it);
+    }
+    child.leasedResources.clear();
+}
+
+/**
+ * @brief Run a group of sibling nested processes in parallel
+ * @param children Nested processes to run
+ *
+ * At most one worker per hardware thread is started. Each worker takes the first child whose
+ * lease can be granted, runs it against its own pool plus the leased resources, and returns the
+ * lease as soon as the child finishes. Children that need a resource leased to a sibling wait
+ * until that sibling returns its lease, so siblings never contend on the parent's pool.
+ */
+void Process::executeNested(const std::vector<Process *> &children) {
+    std::mutex leaseMutex;
+    std::condition_variable leaseReturned;
+    std::vector<Process *> waiting = children;
+    std::vector<Process *> holders;
+    holders.reserve(children.size());
+
+    // Returns the lease of a child when its run ends, even if the run is interrupted by an exception
+    struct LeaseGuard {
+        Process &parent;
+        Process &child;
+        std::mutex &leaseMutex;
+        std::condition_variable &leaseReturned;
+        std::vector<Process *> &holders;
+
+        ~LeaseGuard() {
+            {
+                std::lock_guard lock(leaseMutex);
+                parent.reclaimResourcesFrom(child);
+                holders.erase(std::find(holders.begin(), holders.end(), &child));
+            }
+            leaseReturned.notify_all();
+        }
+    };
+
+    auto worker = [&] {
+        for (;;) {
+            Process *granted = nullptr;
+            {
+                std::unique_lock lock(leaseMutex);
+                while (granted == nullptr && !waiting.empty()) {
+                    for (auto it = waiting.begin(); it != waiting.end();) {
+                        const auto result = leaseResourcesTo(**it, holders);
+                        if (result == LeaseResult::Deferred) {
+                            ++it;
+                            continue;
+                        }
+                        if (result == LeaseResult::Granted) {
+                            granted = *it;
+                            holders.push_back(granted);
+                        } else {
+                            std::cout << (*it)->getName() << " skipped: required resources not available." << std::endl;
+                        }
+                        it = waiting.erase(it);
+                        if (granted != nullptr) break;
+                    }
+                    // Every waiting child is deferred by a sibling that is still running
+                    if (granted == nullptr && !waiting.empty()) leaseReturned.wait(lock);
+                }
+            }
+            if (granted == nullptr) return;
+            LeaseGuard guard{*this, *granted, leaseMutex, leaseReturned, holders};
+            granted->run();
         }
+    };
+
+    const std::size_t workerCount = std::min<std::size_t>(children.size(),
+                                                          std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::jthread> workers;
+    workers.reserve(workerCount);
+    for (std::size_t i = 0; i < workerCount; ++i) {
+        workers.emplace_back(worker);
     }
+}
+
+/**
+ * @brief Run the tasks of the process in order
+ *
+ * Consecutive nested processes are grouped and run in parallel.
+ */
+void Process::executeTasks() {
+    std::vector<Process*> nestedGroup;
+    auto runNestedGroup = [this, &nestedGroup] {
+        if (nestedGroup.empty()) return;
+        try {
+            executeNested(nestedGroup);
+        } catch (const std::exception &e) {
+            std::cerr << "Error executing nested processes of " << name << ": " << e.what() << std::endl;
+        }
+        nestedGroup.clear();
+    };
 
     for (const auto& task : tasks) {
+        if (auto *nested = dynamic_cast<Process*>(task.get())) {
+            nestedGroup.push_back(nested);
+            continue;
+        }
+        runNestedGroup();
         try {
             if (task->canExecute(resourcePool)) {
                 task->assignResources(resourcePool);
@@ -60,6 +227,23 @@ void Process::execute() const {
             std::cerr << "Error executing task " << task->getName() << ": " << e.what() << std::endl;
         }
     }
+    runNestedGroup();
+}
+
+/**
+ * @brief Execute the process and its tasks
+ */
+void Process::execute() {
+    if (!requiredResourceNames.empty() && assignedResources.size() != requiredResourceNames.size()) {
+        throw std::runtime_error("Required resource names mismatch for process: " + name);
+    }
+    std::cout << "Executing Process: " << name << " - " << description << std::endl;
+    if (!assignedResources.empty()) {
+        for (const auto* resource : assignedResources) {
+            resource->use();
+        }
+    }
+    executeTasks();
 }
 
 /**
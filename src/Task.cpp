@@ -20,7 +20,7 @@ Task::Task(const std::string &name, const std::string &description,
  * @brief Execute the task by utilizing its assigned resources
  * @throws std::runtime_error if resources are not properly assigned
  */
-void Task::execute() const {
+void Task::execute() {
     if (assignedResources.size() != requiredResourceNames.size()) {
         throw std::runtime_error("Resources not properly assigned for task: '" + name + "'");
     }
@@ -51,6 +51,7 @@ void UsableResource::release() {
     if (isAvailable) {
         std::cerr << "Warning: Usable resource '" << name << "' is already released." << std::endl;
     }
+    isAvailable = true;
 }
 
 /**